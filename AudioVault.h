@@ -39,6 +39,9 @@
 #include <types.h>
 
 #include <VaultEntry.h>
+#include <VaultSnapshot.h>
+#include <VaultWarmer.h>
+#include <SampleArena.h>
 
 typedef vault_entry<Mix_Music> MusicEntry;
 typedef vault_entry<Mix_Chunk> ChunkEntry;
@@ -49,6 +52,9 @@ protected:
     std::vector<ChunkEntry> m_vChunks;
     unsigned long m_ulExpirationTime = 0;
     SDL_TimerID m_TimerID = 0;
+    unsigned long m_ulWarmUpGrace = DEFAULT_WARMUP_GRACE;
+    VaultWarmer m_Warmer;
+    std::vector< std::unique_ptr<SampleArena> > m_vChunkGroups; //Indexed by group id.
 
 public:
     ////////////////////////////////////////////////
@@ -70,9 +76,13 @@ public:
     ////////////////////////////////////////////////
     /// Checks if a chunk exists in the vault and returns a strong reference to it. Loads from disk otherwise.
     /// @param p_sPath The path to the sound file.
+    /// @param p_uiGroup The chunk group that will hold the sample data if it is loaded. INVALID_UNIQUE_ID uses the heap.
+    ///     A resident chunk that has no group yet (e.g. loaded by WarmUp()) has its samples moved into p_uiGroup, unless it is playing.
+    ///     The Mix_Chunk pointer doesn't change.
     /// @return Shared Pointer to the chunk. Returns a NULL pointer if it can't find and fails loading the file.
+    /// @see CreateChunkGroup()
     ////////////////////////////////////////////////
-    std::shared_ptr<Mix_Chunk*> GetChunk (std::string p_sPath);
+    std::shared_ptr<Mix_Chunk*> GetChunk (std::string p_sPath, unsigned int p_uiGroup = INVALID_UNIQUE_ID);
 
     ////////////////////////////////////////////////
     /// Pushes a chunk into the vault.
@@ -83,6 +93,40 @@ public:
     ////////////////////////////////////////////////
     std::shared_ptr<Mix_Chunk*> PushNewChunk (Mix_Chunk* p_pChunk, std::string p_sPath);
 
+    ////////////////////////////////////////////////
+    /// Creates a chunk group. Sample data of the chunks loaded into a group is kept in large slabs owned by the vault.
+    /// Use one group per scene (or any set of sounds that are dropped together).
+    /// @param p_uiSlabSize The size of each slab of the group.
+    /// @return The id of the new group.
+    /// @see PurgeChunkGroup()
+    ////////////////////////////////////////////////
+    unsigned int CreateChunkGroup (size_t p_uiSlabSize = DEFAULT_SLAB_SIZE);
+
+    ////////////////////////////////////////////////
+    /// Destroys all chunks of a group and frees its sample memory. The group can be used again afterwards.
+    /// Channels playing the group are halted in a single pass, the sample memory is freed one slab at a time,
+    ///     but each chunk still costs one small free, so the release is linear in the group's chunks.
+    /// @param p_uiGroup The group id.
+    /// @warning May leave orphan pointers! Same as Purge(), but only for the group.
+    ////////////////////////////////////////////////
+    void PurgeChunkGroup (unsigned int p_uiGroup);
+
+    ////////////////////////////////////////////////
+    /// Moves the sample data of the resident chunks of a group into a single slab,
+    /// giving back the memory left behind by chunks freed with FreeUnused().
+    /// @param p_uiGroup The group id.
+    /// @return False if a chunk of the group is playing or the new slab can't be allocated. Nothing is changed then.
+    ///     True without moving anything if no chunk of the group was freed.
+    /// @note The Mix_Chunk pointers stay the same, only their sample buffers move.
+    ////////////////////////////////////////////////
+    bool CompactChunkGroup (unsigned int p_uiGroup);
+
+    ////////////////////////////////////////////////
+    /// @param p_uiGroup The group id.
+    /// @return Bytes of sample memory held by the group.
+    ////////////////////////////////////////////////
+    size_t GetChunkGroupMemory (unsigned int p_uiGroup) const;
+
     ////////////////////////////////////////////////
     /// Checks if a music exists in the vault and returns a direct pointer to it.
     /// @param p_sPath The path to the sound file.
@@ -114,17 +158,49 @@ public:
 
     ////////////////////////////////////////////////
     /// Manual call to free all unused (and expired) assets.
+    /// @note Sample data of grouped chunks stays in the group until PurgeChunkGroup() or CompactChunkGroup().
     /// @see SetAutoFree()
     /// @see StopAutoFree()
     ////////////////////////////////////////////////
     bool FreeUnused ();
 
     ////////////////////////////////////////////////
-    /// Destroys all assets contained in the vault. Unused or not.
+    /// Destroys all assets contained in the vault. Unused or not. Chunk groups are emptied but remain valid.
     /// @warning May leave orphan pointers! Remember, the shared_ptr are pointers to pointers.
     ////////////////////////////////////////////////
     void Purge ();
 
+    ////////////////////////////////////////////////
+    /// Writes the paths, access counts and use order of all resident musics and chunks to a file.
+    /// Call it before shutting down (or whenever the working set is representative).
+    /// @param p_sFile The snapshot file. It is overwritten.
+    /// @return True if the file was written.
+    /// @see LoadSnapshot()
+    ////////////////////////////////////////////////
+    bool SaveSnapshot (std::string p_sFile);
+
+    ////////////////////////////////////////////////
+    /// Reads a snapshot and starts loading its assets on a worker thread, most important first.
+    /// The assets are added to the vault by WarmUp(). A warm up already in progress is dropped.
+    /// @note The worker only decodes files. The mixer must be open before this call, chunks are converted to its format.
+    /// @param p_sFile The snapshot file written by SaveSnapshot().
+    /// @return False if the file can't be read.
+    /// @see WarmUp()
+    ////////////////////////////////////////////////
+    bool LoadSnapshot (std::string p_sFile);
+
+    ////////////////////////////////////////////////
+    /// Adds the assets loaded by the worker to the vault. Call it once per frame to rehydrate the vault while the game runs.
+    /// It never waits for the worker. Assets already in the vault only get the carried access count.
+    /// @param p_ulBudgetMS Time in milliseconds this call may spend. At least one loaded asset is handled when available.
+    /// @return The number of assets still queued, being loaded or waiting to be added.
+    /// @note Warmed assets are kept by FreeUnused() for the warm up grace time on top of the expiration time,
+    ///     or until they are first requested.
+    /// @see SetWarmUpGrace()
+    /// @see LoadSnapshot()
+    ////////////////////////////////////////////////
+    unsigned int WarmUp (unsigned long p_ulBudgetMS = DEFAULT_WARMUP_BUDGET);
+
     ////////////////////////////////////////////////
     /// Sets an expiration time that an asset needs to be unused before being freed.
     /// @see FreeUnused();
@@ -134,6 +210,15 @@ public:
         m_ulExpirationTime = p_ulExpirationTime;
     }
 
+    ////////////////////////////////////////////////
+    /// Sets the extra time an asset loaded by WarmUp() is kept while it waits to be requested.
+    /// @see WarmUp();
+    /// @see FreeUnused();
+    ////////////////////////////////////////////////
+    inline void SetWarmUpGrace(unsigned long p_ulWarmUpGrace) {
+        m_ulWarmUpGrace = p_ulWarmUpGrace;
+    }
+
     ////////////////////////////////////////////////
     /// Constructor for the AudioVault.
     /// @param p_ulExpirationTime The time an asset needs to stay unused before being freed.
@@ -155,6 +240,17 @@ protected:
         Mix_FreeChunk( *(p_Entry.m_pData) );
         p_Entry.m_pData.reset();
     }
+
+    //Moves the samples of a chunk that isn't playing into a group. The Mix_Chunk itself stays the same.
+    //Returns false, leaving the chunk untouched, if the group can't allocate the samples.
+    bool MoveChunkToGroup(Mix_Chunk* p_pChunk, unsigned int p_uiGroup);
+
+    //True if any mixer channel is playing the chunk.
+    static bool IsChunkPlaying(Mix_Chunk* p_pChunk);
+
+    //Warm up worker callbacks, loading musics or chunks by the snapshot kind.
+    static void* WarmLoad(const vault_snapshot_entry& p_Snap);
+    static void WarmFree(const vault_snapshot_entry& p_Snap, void* p_pData);
 private:
 
 };
@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Dejaime Antônio de Oliveira Neto
+//     Created on 20261019 ymd
+//
+// X11 Licensed Code
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef SAMPLEARENA_H
+#define SAMPLEARENA_H
+
+#define DEFAULT_SLAB_SIZE (1024*1024)
+#define SAMPLE_ALIGNMENT 16
+
+#include <SDL.h>
+
+#include <types.h>
+
+////////////////////////////////////////////////
+/// Bump allocator for audio sample data.
+/// Memory is taken from large slabs and is only given back all at once, through Release().
+////////////////////////////////////////////////
+class SampleArena {
+protected:
+    std::vector<Uint8*> m_vSlabs;
+    size_t m_uiSlabSize;
+    size_t m_uiCurrentSize = 0;  //Size of the slab being filled, always the last one. 0 if there is none.
+    size_t m_uiCurrentUsed = 0;  //Bytes taken from the slab being filled.
+    size_t m_uiReserved = 0;     //Bytes held by all slabs.
+    size_t m_uiUsed = 0;         //Bytes handed out by Allocate(), in all slabs.
+
+public:
+    ////////////////////////////////////////////////
+    /// Takes p_uiBytes from the current slab, starting a new one if it doesn't fit.
+    /// @param p_uiBytes Number of bytes needed. Requests larger than the slab size that don't fit in the current slab
+    ///     get a slab of their own, and the current slab keeps being filled.
+    /// @return Pointer to the memory, aligned to SAMPLE_ALIGNMENT. NULL if the allocation fails.
+    ////////////////////////////////////////////////
+    Uint8* Allocate (size_t p_uiBytes);
+
+    ////////////////////////////////////////////////
+    /// Makes sure the next p_uiBytes can be allocated from the current slab.
+    /// @param p_uiBytes Number of bytes that will be allocated.
+    /// @note If a new slab is started, whatever is left in the previous one is lost until Release().
+    /// @return False if a new slab was needed and couldn't be allocated.
+    ////////////////////////////////////////////////
+    bool Reserve (size_t p_uiBytes);
+
+    ////////////////////////////////////////////////
+    /// Frees all slabs at once. Every pointer returned by Allocate() becomes invalid.
+    ////////////////////////////////////////////////
+    void Release ();
+
+    ////////////////////////////////////////////////
+    /// Rounds a size up so the allocation after it stays aligned to SAMPLE_ALIGNMENT.
+    /// @param p_uiBytes The requested size.
+    /// @return The bytes Allocate() actually takes for p_uiBytes.
+    ////////////////////////////////////////////////
+    static inline size_t AlignedSize (size_t p_uiBytes) {
+        return (p_uiBytes + SAMPLE_ALIGNMENT - 1) & ~(size_t)(SAMPLE_ALIGNMENT - 1);
+    }
+
+    ////////////////////////////////////////////////
+    /// @return Total bytes held by the arena, used or not.
+    ////////////////////////////////////////////////
+    size_t GetReservedBytes () const { return m_uiReserved; }
+
+    ////////////////////////////////////////////////
+    /// @return Total bytes handed out by Allocate(), aligned as by AlignedSize().
+    ////////////////////////////////////////////////
+    size_t GetUsedBytes () const { return m_uiUsed; }
+
+    ////////////////////////////////////////////////
+    /// @return The size of new slabs.
+    ////////////////////////////////////////////////
+    size_t GetSlabSize () const { return m_uiSlabSize; }
+
+    ////////////////////////////////////////////////
+    /// Constructor for the SampleArena. No memory is allocated until needed.
+    /// @param p_uiSlabSize The size of each slab.
+    ////////////////////////////////////////////////
+    SampleArena(size_t p_uiSlabSize = DEFAULT_SLAB_SIZE);
+    virtual ~SampleArena();
+
+private:
+    //protecting copy ctor and assign
+    SampleArena(const SampleArena&):
+        m_vSlabs(), m_uiSlabSize(0) {}
+    SampleArena& operator= (const SampleArena&) {return *this;}
+
+};
+
+#endif // SAMPLEARENA_H
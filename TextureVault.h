@@ -33,6 +33,8 @@
 #include <types.h>
 
 #include <VaultEntry.h>
+#include <VaultSnapshot.h>
+#include <VaultWarmer.h>
 
 typedef vault_entry<SDL_Texture> TEntry;
 
@@ -42,6 +44,8 @@ protected:
     SDL_Renderer *m_pRenderer = NULL;
     unsigned long m_ulExpirationTime = 0;
     SDL_TimerID m_TimerID = 0;
+    unsigned long m_ulWarmUpGrace = DEFAULT_WARMUP_GRACE;
+    VaultWarmer m_Warmer;
 public:
     ////////////////////////////////////////////////
     /// Searches for the path in the loaded textures and return a strong reference if found.
@@ -114,6 +118,37 @@ public:
     ////////////////////////////////////////////////
     void Purge ();
 
+    ////////////////////////////////////////////////
+    /// Writes the paths, access counts and use order of all resident textures to a file.
+    /// Call it before shutting down (or whenever the working set is representative).
+    /// @param p_sFile The snapshot file. It is overwritten.
+    /// @return True if the file was written.
+    /// @see LoadSnapshot()
+    ////////////////////////////////////////////////
+    bool SaveSnapshot (std::string p_sFile);
+
+    ////////////////////////////////////////////////
+    /// Reads a snapshot and starts decoding its images on a worker thread, most important first.
+    /// The textures are created by WarmUp(). A warm up already in progress is dropped.
+    /// @param p_sFile The snapshot file written by SaveSnapshot().
+    /// @return False if the file can't be read.
+    /// @see WarmUp()
+    ////////////////////////////////////////////////
+    bool LoadSnapshot (std::string p_sFile);
+
+    ////////////////////////////////////////////////
+    /// Creates textures from the images decoded by the worker. Call it once per frame to rehydrate the vault while the game runs.
+    /// It never waits for the worker. Textures already in the vault only get the carried access count.
+    /// @param p_ulBudgetMS Time in milliseconds this call may spend. At least one decoded image is handled when available.
+    /// @return The number of textures still queued, being decoded or waiting to be created.
+    /// @note Must be called from the thread that owns the renderer.
+    /// @note Warmed textures are kept by FreeUnused() for the warm up grace time on top of the expiration time,
+    ///     or until they are first requested.
+    /// @see SetWarmUpGrace()
+    /// @see LoadSnapshot()
+    ////////////////////////////////////////////////
+    unsigned int WarmUp (unsigned long p_ulBudgetMS = DEFAULT_WARMUP_BUDGET);
+
     ////////////////////////////////////////////////
     /// Sets an expiration time that an asset needs to be unused before being freed.
     /// @see FreeUnused();
@@ -123,6 +158,15 @@ public:
         m_ulExpirationTime = p_ulExpirationTime;
     }
 
+    ////////////////////////////////////////////////
+    /// Sets the extra time a texture loaded by WarmUp() is kept while it waits to be requested.
+    /// @see WarmUp();
+    /// @see FreeUnused();
+    ////////////////////////////////////////////////
+    inline void SetWarmUpGrace (unsigned long p_ulWarmUpGrace) {
+        m_ulWarmUpGrace = p_ulWarmUpGrace;
+    }
+
     ////////////////////////////////////////////////
     /// Constructor for the AudioVault.
     /// @param p_Renderer The renderer of the vault.
@@ -149,6 +193,10 @@ protected:
     //  to use a shared texture for that (what wouldn't be wise).
     SDL_Texture* LoadTexture (const char* p_pcPath);
 
+    //Warm up worker callbacks, decoding to surfaces.
+    static void* WarmLoad(const vault_snapshot_entry& p_Snap);
+    static void WarmFree(const vault_snapshot_entry& p_Snap, void* p_pData);
+
 public:
 
     ////////////////////////////////////////////////
@@ -173,7 +221,7 @@ public:
 private:
     //protecting copy ctor and assign
     TextureVault(const TextureVault&):
-        m_vTextures(), m_pRenderer(NULL), m_ulExpirationTime(0){}
+        m_vTextures(), m_pRenderer(NULL), m_ulExpirationTime(0), m_Warmer(WarmLoad, WarmFree){}
     TextureVault& operator= (const TextureVault&) {return *this;}
 
 };
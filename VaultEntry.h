@@ -30,14 +30,49 @@
 
 template <typename Type> struct vault_entry{
     unsigned long m_ulExpiring = 0;
+    unsigned long m_ulHits = 0;     //Number of times the asset was requested.
+    unsigned long m_ulLastUse = 0;  //SDL_GetTicks() of the last request.
+    unsigned int m_uiGroup = INVALID_UNIQUE_ID; //Memory group owning the asset data, if any.
+    bool m_bWarmed = false;         //Loaded by a warm up and not requested since.
     std::shared_ptr<Type*> m_pData = NULL;
     std::string m_sPath;
 
     vault_entry (const std::string p_sPath):
         m_sPath(p_sPath) {}
     vault_entry (const vault_entry& p_Copy):
+        m_ulExpiring(p_Copy.m_ulExpiring), m_ulHits(p_Copy.m_ulHits), m_ulLastUse(p_Copy.m_ulLastUse),
+        m_uiGroup(p_Copy.m_uiGroup), m_bWarmed(p_Copy.m_bWarmed),
         m_pData(p_Copy.m_pData), m_sPath(p_Copy.m_sPath) {}
 
+    //Marks the entry as requested, resetting its expiration.
+    void Touch () {
+        m_ulExpiring = 0;
+        ++m_ulHits;
+        m_ulLastUse = SDL_GetTicks();
+        m_bWarmed = false;
+    }
+
+    //Adds the access count from the previous run, halved so old favorites fade out of the snapshot.
+    void CarryHits (unsigned long p_ulCarriedHits) {
+        m_ulHits += p_ulCarriedHits / 2;
+    }
+
+    //Marks the entry as loaded by a warm up. It was not requested in this run yet,
+    //  and its expiration starts counting from now.
+    void Warm (unsigned long p_ulCarriedHits) {
+        m_ulHits = 0;
+        CarryHits(p_ulCarriedHits);
+        m_ulLastUse = 0;
+        m_ulExpiring = SDL_GetTicks();
+        m_bWarmed = true;
+    }
+
+    //Warmed entries that were never requested get p_ulGrace more milliseconds before expiring.
+    bool IsExpired (unsigned long p_ulExpirationTime, unsigned long p_ulGrace) const {
+        if (m_bWarmed) p_ulExpirationTime += p_ulGrace;
+        return SDL_GetTicks() - m_ulExpiring >= p_ulExpirationTime;
+    }
+
     virtual ~vault_entry(){}
 };
 
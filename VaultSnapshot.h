@@ -0,0 +1,140 @@
+#ifndef VAULTSNAPSHOT_H_INCLUDED
+#define VAULTSNAPSHOT_H_INCLUDED
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Dejaime Antônio de Oliveira Neto
+//     Created on 20261019 ymd
+//
+// X11 Licensed Code
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+
+#include <types.h>
+
+#include <VaultEntry.h>
+
+//Snapshot file layout, one asset per line after the header:
+//  <kind> <hits> <path>
+//Lines are written most important first, which is also the warm up order.
+//The last use order only breaks ties in that order, so it isn't stored.
+#define VAULT_SNAPSHOT_HEADER "SDL_vault_snapshot 2"
+//Time a warmed asset is kept, on top of the expiration time, while it waits for its first request.
+#define DEFAULT_WARMUP_GRACE 30000
+
+struct vault_snapshot_entry {
+    char m_cKind = 0;               //Which vector of the vault the asset belongs to.
+    unsigned long m_ulHits = 0;
+    unsigned long m_ulLastUse = 0;  //Ticks of the last use when collected. Not stored in the file.
+    std::string m_sPath;
+};
+
+////////////////////////////////////////////////
+/// Appends the resident assets of a vault vector to a snapshot list.
+/// Warmed assets that were never requested and have no carried access count left are skipped,
+///     so assets drop out of the snapshot once they stop being used.
+/// @param p_vSnapshot The list being built.
+/// @param p_vEntries The vault entries to collect.
+/// @param p_cKind A character tagging which vector the entries came from.
+////////////////////////////////////////////////
+template <typename Type>
+static inline void CollectVaultSnapshot (std::vector<vault_snapshot_entry>& p_vSnapshot,
+                                         const std::vector< vault_entry<Type> >& p_vEntries, char p_cKind) {
+    for (auto& t_Entry : p_vEntries) {
+        if (t_Entry.m_bWarmed && t_Entry.m_ulHits == 0) continue;
+
+        vault_snapshot_entry t_Snap;
+        t_Snap.m_cKind = p_cKind;
+        t_Snap.m_ulHits = t_Entry.m_ulHits;
+        t_Snap.m_ulLastUse = t_Entry.m_ulLastUse;
+        t_Snap.m_sPath = t_Entry.m_sPath;
+        p_vSnapshot.push_back(t_Snap);
+    }
+}
+
+////////////////////////////////////////////////
+/// Carries the access count of a snapshot entry over to the matching resident asset, if there is one.
+/// @param p_vEntries The vault entries to search.
+/// @param p_Snap The snapshot entry.
+/// @return True if the asset is already resident, so it doesn't need to be warmed.
+////////////////////////////////////////////////
+template <typename Type>
+static inline bool CarryVaultSnapshot (std::vector< vault_entry<Type> >& p_vEntries, const vault_snapshot_entry& p_Snap) {
+    for (auto& t_Entry : p_vEntries)
+        if (t_Entry.m_sPath == p_Snap.m_sPath) {
+            t_Entry.CarryHits(p_Snap.m_ulHits);
+            return true;
+        }
+    return false;
+}
+
+////////////////////////////////////////////////
+/// Sorts a collected snapshot by importance and writes it to disk.
+/// Importance is the access count, ties are broken by the most recent use.
+/// @param p_sFile The snapshot file. It is overwritten.
+/// @param p_vSnapshot The entries, as built by CollectVaultSnapshot().
+/// @return True if the file was written.
+////////////////////////////////////////////////
+static inline bool WriteVaultSnapshot (std::string p_sFile, std::vector<vault_snapshot_entry> p_vSnapshot) {
+    //Newest first, then a stable sort by hits keeps that order among equal counts.
+    std::stable_sort(p_vSnapshot.begin(), p_vSnapshot.end(),
+        [](const vault_snapshot_entry& a, const vault_snapshot_entry& b) { return a.m_ulLastUse > b.m_ulLastUse; });
+    std::stable_sort(p_vSnapshot.begin(), p_vSnapshot.end(),
+        [](const vault_snapshot_entry& a, const vault_snapshot_entry& b) { return a.m_ulHits > b.m_ulHits; });
+
+    std::ofstream t_File(p_sFile.c_str(), std::ios::out | std::ios::trunc);
+    if (!t_File) return false;
+
+    t_File << VAULT_SNAPSHOT_HEADER << '\n';
+    for (auto& t_Snap : p_vSnapshot)
+        t_File << t_Snap.m_cKind << ' ' << t_Snap.m_ulHits << ' ' << t_Snap.m_sPath << '\n';
+
+    return (bool)t_File;
+}
+
+////////////////////////////////////////////////
+/// Reads a snapshot written by WriteVaultSnapshot().
+/// @param p_sFile The snapshot file.
+/// @param p_vSnapshot Receives the entries, most important first.
+/// @return False if the file can't be opened or is not a snapshot.
+////////////////////////////////////////////////
+static inline bool ReadVaultSnapshot (std::string p_sFile, std::vector<vault_snapshot_entry>& p_vSnapshot) {
+    std::ifstream t_File(p_sFile.c_str());
+    if (!t_File) return false;
+
+    std::string t_sLine;
+    if (!std::getline(t_File, t_sLine) || t_sLine != VAULT_SNAPSHOT_HEADER) return false;
+
+    vault_snapshot_entry t_Snap;
+    while (t_File >> t_Snap.m_cKind >> t_Snap.m_ulHits) {
+        //The path is the rest of the line, and may contain spaces.
+        t_File.get();
+        if (!std::getline(t_File, t_Snap.m_sPath)) break;
+        if (!t_Snap.m_sPath.empty()) p_vSnapshot.push_back(t_Snap);
+    }
+
+    return true;
+}
+
+#endif // VAULTSNAPSHOT_H_INCLUDED
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Dejaime Antônio de Oliveira Neto
+//     Created on 20261019 ymd
+//
+// X11 Licensed Code
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef VAULTWARMER_H
+#define VAULTWARMER_H
+
+//Decoded assets waiting for WarmUp() before the worker pauses.
+#define WARMUP_READY_MAX 4
+//Default time, in milliseconds, a WarmUp() call may spend.
+#define DEFAULT_WARMUP_BUDGET 2
+
+#include <deque>
+
+#include <SDL.h>
+
+#include <types.h>
+
+#include <VaultSnapshot.h>
+
+////////////////////////////////////////////////
+/// Decodes the assets of a snapshot on a worker thread, most important first.
+/// The vault takes the decoded data with Pop() on its own thread and turns it into entries.
+////////////////////////////////////////////////
+class VaultWarmer {
+public:
+    //Decodes an asset on the worker thread. Returns NULL on failure.
+    typedef void* (*LoadFunction)(const vault_snapshot_entry& p_Snap);
+    //Frees decoded data that was never popped.
+    typedef void (*FreeFunction)(const vault_snapshot_entry& p_Snap, void* p_pData);
+
+protected:
+    std::vector<vault_snapshot_entry> m_vQueue; //Next asset to decode is at the back.
+    std::deque< std::pair<vault_snapshot_entry, void*> > m_dReady;
+    unsigned int m_uiDecoding = 0;  //Assets taken from the queue but not ready yet.
+    bool m_bStop = false;
+    LoadFunction m_pLoad;
+    FreeFunction m_pFree;
+    SDL_Thread* m_pThread = NULL;
+    SDL_mutex* m_pMutex = NULL;
+    SDL_cond* m_pCond = NULL;
+
+public:
+    ////////////////////////////////////////////////
+    /// Stops any previous warm up and starts decoding the given assets.
+    /// @param p_vSnapshot The assets to decode, most important first.
+    ////////////////////////////////////////////////
+    void Start (const std::vector<vault_snapshot_entry>& p_vSnapshot);
+
+    ////////////////////////////////////////////////
+    /// Stops the worker and frees everything decoded but not popped.
+    ////////////////////////////////////////////////
+    void Stop ();
+
+    ////////////////////////////////////////////////
+    /// Takes the next decoded asset, if there is one. Never waits for the worker.
+    /// @param p_Snap Receives the snapshot entry of the asset.
+    /// @param p_pData Receives the decoded data. The caller owns it from now on.
+    /// @return False if nothing is ready.
+    /// @note Decodes on the caller's thread if the worker couldn't be created.
+    ////////////////////////////////////////////////
+    bool Pop (vault_snapshot_entry& p_Snap, void*& p_pData);
+
+    ////////////////////////////////////////////////
+    /// @return Number of assets still queued, being decoded or waiting to be popped.
+    ////////////////////////////////////////////////
+    unsigned int GetPending ();
+
+    ////////////////////////////////////////////////
+    /// Constructor for the VaultWarmer.
+    /// @param p_pLoad Function decoding an asset. Called from the worker thread.
+    /// @param p_pFree Function freeing decoded data that was never popped.
+    ////////////////////////////////////////////////
+    VaultWarmer(LoadFunction p_pLoad, FreeFunction p_pFree);
+    virtual ~VaultWarmer();
+
+protected:
+    static int Run(void* p_Warmer);
+
+private:
+    //protecting copy ctor and assign
+    VaultWarmer(const VaultWarmer&):
+        m_pLoad(NULL), m_pFree(NULL) {}
+    VaultWarmer& operator= (const VaultWarmer&) {return *this;}
+
+};
+
+#endif // VAULTWARMER_H
@@ -1,19 +1,25 @@
 #include "AudioVault.h"
+#include <algorithm>
 #include <iostream>
 
 AudioVault::AudioVault(unsigned long p_ulExpirationTime, unsigned long p_ulAutoFreeTime):
-    m_vMusics(), m_vChunks(), m_ulExpirationTime(p_ulExpirationTime) {
+    m_vMusics(), m_vChunks(), m_ulExpirationTime(p_ulExpirationTime), m_Warmer(WarmLoad, WarmFree) {
     if (p_ulAutoFreeTime > 0) SetAutoFree(p_ulAutoFreeTime);
 }
 
 AudioVault::~AudioVault() {
     StopAutoFree();
+    m_Warmer.Stop();
+    //Grouped samples die with the vault, so their chunks can't outlive it.
+    for (auto t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup != INVALID_UNIQUE_ID)
+            Mix_FreeChunk(*t_Entry.m_pData);
 }
 
 std::shared_ptr<Mix_Music*> AudioVault::GetMusic(std::string p_sPath) {
-    for (auto t_Entry : m_vMusics)
+    for (auto& t_Entry : m_vMusics)
         if (t_Entry.m_sPath == p_sPath) {
-            t_Entry.m_ulExpiring = 0;
+            t_Entry.Touch();
             return std::shared_ptr<Mix_Music*>(t_Entry.m_pData);
         }
 
@@ -28,6 +34,7 @@ std::shared_ptr<Mix_Music*> AudioVault::GetMusic(std::string p_sPath) {
 
 std::shared_ptr<Mix_Music*> AudioVault::PushNewMusic (Mix_Music* p_pMusic, std::string p_sPath) {
     MusicEntry t_MusicEntry(p_sPath);
+    t_MusicEntry.Touch();
 
     t_MusicEntry.m_pData = std::make_shared<Mix_Music*>(p_pMusic);
 
@@ -41,10 +48,15 @@ std::shared_ptr<Mix_Music*> AudioVault::PushNewMusic (Mix_Music* p_pMusic, std::
 
 
 
-std::shared_ptr<Mix_Chunk*> AudioVault::GetChunk(std::string p_sPath) {
-    for (auto t_Entry : m_vChunks)
+std::shared_ptr<Mix_Chunk*> AudioVault::GetChunk(std::string p_sPath, unsigned int p_uiGroup) {
+    for (auto& t_Entry : m_vChunks)
         if (t_Entry.m_sPath == p_sPath) {
-            t_Entry.m_ulExpiring = 0;
+            t_Entry.Touch();
+            //Chunks resident without a group (e.g. loaded by WarmUp()) join the first group they are requested with.
+            //The samples of a playing chunk can't move, it will be moved on a later request.
+            if (t_Entry.m_uiGroup == INVALID_UNIQUE_ID && p_uiGroup < m_vChunkGroups.size()
+                && !IsChunkPlaying(*t_Entry.m_pData) && MoveChunkToGroup(*t_Entry.m_pData, p_uiGroup))
+                t_Entry.m_uiGroup = p_uiGroup;
             return std::shared_ptr<Mix_Chunk*>(t_Entry.m_pData);
         }
 
@@ -55,12 +67,117 @@ std::shared_ptr<Mix_Chunk*> AudioVault::GetChunk(std::string p_sPath) {
 
     if (t_pChunk == NULL) return std::shared_ptr<Mix_Chunk*>();
 
+    bool t_bGrouped = p_uiGroup < m_vChunkGroups.size() && MoveChunkToGroup(t_pChunk, p_uiGroup);
+    std::shared_ptr<Mix_Chunk*> t_pRet = PushNewChunk(t_pChunk, p_sPath);
+    if (t_bGrouped) m_vChunks.back().m_uiGroup = p_uiGroup;
+
     //Returns the reference.
-    return PushNewChunk(t_pChunk, p_sPath);
+    return t_pRet;
+}
+
+bool AudioVault::MoveChunkToGroup(Mix_Chunk* p_pChunk, unsigned int p_uiGroup) {
+    Uint8* t_pSamples = m_vChunkGroups[p_uiGroup]->Allocate(p_pChunk->alen);
+    if (t_pSamples == NULL) return false;
+
+    SDL_memcpy(t_pSamples, p_pChunk->abuf, p_pChunk->alen);
+
+    //The mixer allocates the buffer with SDL_malloc, and Mix_FreeChunk frees it only when allocated is set.
+    //Clearing it leaves Mix_FreeChunk freeing just the struct, like a QuickLoad chunk.
+    if (p_pChunk->allocated) SDL_free(p_pChunk->abuf);
+    p_pChunk->abuf = t_pSamples;
+    p_pChunk->allocated = 0;
+    return true;
+}
+
+bool AudioVault::IsChunkPlaying(Mix_Chunk* p_pChunk) {
+    int t_iChannels = Mix_AllocateChannels(-1);
+    for (int i = 0; i < t_iChannels; ++i)
+        if (Mix_Playing(i) && Mix_GetChunk(i) == p_pChunk)
+            return true;
+    return false;
+}
+
+unsigned int AudioVault::CreateChunkGroup(size_t p_uiSlabSize) {
+    m_vChunkGroups.push_back(std::unique_ptr<SampleArena>(new SampleArena(p_uiSlabSize)));
+    return m_vChunkGroups.size() - 1;
+}
+
+void AudioVault::PurgeChunkGroup(unsigned int p_uiGroup) {
+    if (p_uiGroup >= m_vChunkGroups.size()) return;
+
+    std::vector<Mix_Chunk*> t_vGroup;
+    for (auto& t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup == p_uiGroup)
+            t_vGroup.push_back(*t_Entry.m_pData);
+    std::sort(t_vGroup.begin(), t_vGroup.end());
+
+    //A single pass over the channels, instead of the one per chunk Mix_FreeChunk would do.
+    //Channels must stop before the samples are released.
+    int t_iChannels = Mix_AllocateChannels(-1);
+    for (int i = 0; i < t_iChannels; ++i)
+        if (Mix_Playing(i) && std::binary_search(t_vGroup.begin(), t_vGroup.end(), Mix_GetChunk(i)))
+            Mix_HaltChannel(i);
+
+    //Grouped chunks don't own their samples, so the SDL_malloc'd struct is all Mix_FreeChunk would free.
+    for (auto t_pChunk : t_vGroup)
+        SDL_free(t_pChunk);
+
+    m_vChunks.erase(std::remove_if(m_vChunks.begin(), m_vChunks.end(),
+        [p_uiGroup](const ChunkEntry& t_Entry) { return t_Entry.m_uiGroup == p_uiGroup; }), m_vChunks.end());
+
+    m_vChunkGroups[p_uiGroup]->Release();
+}
+
+bool AudioVault::CompactChunkGroup(unsigned int p_uiGroup) {
+    if (p_uiGroup >= m_vChunkGroups.size()) return false;
+
+    size_t t_uiTotal = 0;
+    for (auto& t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup == p_uiGroup)
+            t_uiTotal += SampleArena::AlignedSize((*t_Entry.m_pData)->alen);
+
+    //No chunk was freed since the samples were allocated, copying would only double the memory for a while.
+    if (t_uiTotal == m_vChunkGroups[p_uiGroup]->GetUsedBytes()) return true;
+
+    //Playing channels keep pointers into the samples, these can't move.
+    for (auto& t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup == p_uiGroup && IsChunkPlaying(*t_Entry.m_pData))
+            return false;
+
+    std::unique_ptr<SampleArena> t_pArena(new SampleArena(m_vChunkGroups[p_uiGroup]->GetSlabSize()));
+    if (t_uiTotal > 0 && !t_pArena->Reserve(t_uiTotal)) return false;
+
+    //All destinations are taken before anything is copied, so a failure leaves the group untouched.
+    std::vector<Uint8*> t_vSamples;
+    for (auto& t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup == p_uiGroup) {
+            Uint8* t_pSamples = t_pArena->Allocate((*t_Entry.m_pData)->alen);
+            if (t_pSamples == NULL) return false;
+            t_vSamples.push_back(t_pSamples);
+        }
+
+    auto t_pSamples = t_vSamples.begin();
+    for (auto& t_Entry : m_vChunks)
+        if (t_Entry.m_uiGroup == p_uiGroup) {
+            Mix_Chunk* t_pChunk = *t_Entry.m_pData;
+            SDL_memcpy(*t_pSamples, t_pChunk->abuf, t_pChunk->alen);
+            t_pChunk->abuf = *t_pSamples;
+            ++t_pSamples;
+        }
+
+    //The old slabs are freed with the old arena.
+    m_vChunkGroups[p_uiGroup].swap(t_pArena);
+    return true;
+}
+
+size_t AudioVault::GetChunkGroupMemory(unsigned int p_uiGroup) const {
+    if (p_uiGroup >= m_vChunkGroups.size()) return 0;
+    return m_vChunkGroups[p_uiGroup]->GetReservedBytes();
 }
 
 std::shared_ptr<Mix_Chunk*> AudioVault::PushNewChunk (Mix_Chunk* p_pChunk, std::string p_sPath){
     ChunkEntry t_ChunkEntry(p_sPath);
+    t_ChunkEntry.Touch();
 
     t_ChunkEntry.m_pData = std::make_shared<Mix_Chunk*>(p_pChunk);
 
@@ -92,7 +209,7 @@ bool AudioVault::FreeUnused() {
         if ( t_Entry->m_pData.unique() ) {
             if (t_Entry->m_ulExpiring == 0)
                 t_Entry->m_ulExpiring = SDL_GetTicks();
-            if (SDL_GetTicks()-t_Entry->m_ulExpiring >= m_ulExpirationTime) {
+            if (t_Entry->IsExpired(m_ulExpirationTime, m_ulWarmUpGrace)) {
                 Mix_FreeMusic( *t_Entry->m_pData );
                 m_vMusics.erase(t_Entry);
                 t_bFreedSomething = true;
@@ -104,7 +221,7 @@ bool AudioVault::FreeUnused() {
         if ( t_Entry->m_pData.unique() ) {
             if (t_Entry->m_ulExpiring == 0)
                 t_Entry->m_ulExpiring = SDL_GetTicks();
-            if (SDL_GetTicks()-t_Entry->m_ulExpiring >= m_ulExpirationTime) {
+            if (t_Entry->IsExpired(m_ulExpirationTime, m_ulWarmUpGrace)) {
                 Mix_FreeChunk( *t_Entry->m_pData );
                 m_vChunks.erase(t_Entry);
                 t_bFreedSomething = true;
@@ -122,6 +239,66 @@ void AudioVault::Purge() {
         Mix_FreeChunk(*t_Entry.m_pData);
     m_vMusics.clear();
     m_vChunks.clear();
+    for (auto& t_pGroup : m_vChunkGroups)
+        t_pGroup->Release();
+}
+
+bool AudioVault::SaveSnapshot(std::string p_sFile) {
+    std::vector<vault_snapshot_entry> t_vSnapshot;
+    CollectVaultSnapshot(t_vSnapshot, m_vMusics, 'M');
+    CollectVaultSnapshot(t_vSnapshot, m_vChunks, 'C');
+    return WriteVaultSnapshot(p_sFile, t_vSnapshot);
+}
+
+bool AudioVault::LoadSnapshot(std::string p_sFile) {
+    std::vector<vault_snapshot_entry> t_vSnapshot;
+    if (!ReadVaultSnapshot(p_sFile, t_vSnapshot)) return false;
+
+    t_vSnapshot.erase(std::remove_if(t_vSnapshot.begin(), t_vSnapshot.end(),
+        [](const vault_snapshot_entry& t_Snap) { return t_Snap.m_cKind != 'M' && t_Snap.m_cKind != 'C'; }), t_vSnapshot.end());
+    m_Warmer.Start(t_vSnapshot);
+
+    return true;
+}
+
+unsigned int AudioVault::WarmUp(unsigned long p_ulBudgetMS) {
+    unsigned long t_ulStart = SDL_GetTicks();
+    vault_snapshot_entry t_Snap;
+    void* t_pData;
+
+    while (m_Warmer.Pop(t_Snap, t_pData)) {
+        if (t_Snap.m_cKind == 'M') {
+            //Already requested by the game since the snapshot was loaded.
+            if (CarryVaultSnapshot(m_vMusics, t_Snap)) {
+                Mix_FreeMusic((Mix_Music*)t_pData);
+            } else {
+                PushNewMusic((Mix_Music*)t_pData, t_Snap.m_sPath);
+                //Carries a decayed access count over, but it wasn't used in this run yet.
+                m_vMusics.back().Warm(t_Snap.m_ulHits);
+            }
+        } else {
+            if (CarryVaultSnapshot(m_vChunks, t_Snap)) {
+                Mix_FreeChunk((Mix_Chunk*)t_pData);
+            } else {
+                PushNewChunk((Mix_Chunk*)t_pData, t_Snap.m_sPath);
+                m_vChunks.back().Warm(t_Snap.m_ulHits);
+            }
+        }
+
+        if (SDL_GetTicks() - t_ulStart >= p_ulBudgetMS) break;
+    }
+
+    return m_Warmer.GetPending();
+}
+
+void* AudioVault::WarmLoad(const vault_snapshot_entry& p_Snap) {
+    if (p_Snap.m_cKind == 'M') return Mix_LoadMUS(p_Snap.m_sPath.c_str());
+    return Mix_LoadWAV(p_Snap.m_sPath.c_str());
+}
+
+void AudioVault::WarmFree(const vault_snapshot_entry& p_Snap, void* p_pData) {
+    if (p_Snap.m_cKind == 'M') Mix_FreeMusic((Mix_Music*)p_pData);
+    else Mix_FreeChunk((Mix_Chunk*)p_pData);
 }
 
 unsigned int AudioVault::TimedFreeUnused(unsigned int, void* p_AudioVault) {
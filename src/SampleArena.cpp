@@ -0,0 +1,58 @@
+#include "SampleArena.h"
+
+SampleArena::SampleArena(size_t p_uiSlabSize):
+    m_vSlabs(), m_uiSlabSize(p_uiSlabSize) {
+}
+
+SampleArena::~SampleArena() {
+    Release();
+}
+
+bool SampleArena::Reserve(size_t p_uiBytes) {
+    p_uiBytes = AlignedSize(p_uiBytes);
+    if (m_uiCurrentSize > 0 && m_uiCurrentSize - m_uiCurrentUsed >= p_uiBytes) return true;
+
+    size_t t_uiSize = p_uiBytes > m_uiSlabSize ? p_uiBytes : m_uiSlabSize;
+    Uint8* t_pSlab = (Uint8*)SDL_malloc(t_uiSize);
+    if (t_pSlab == NULL) return false;
+
+    m_vSlabs.push_back(t_pSlab);
+    m_uiCurrentSize = t_uiSize;
+    m_uiCurrentUsed = 0;
+    m_uiReserved += t_uiSize;
+    return true;
+}
+
+Uint8* SampleArena::Allocate(size_t p_uiBytes) {
+    //Rounds up so the next allocation stays aligned. SDL_malloc already aligns the slab itself.
+    size_t t_uiBytes = AlignedSize(p_uiBytes);
+
+    if (t_uiBytes > m_uiSlabSize && (m_uiCurrentSize == 0 || m_uiCurrentSize - m_uiCurrentUsed < t_uiBytes)) {
+        //Too big for a regular slab. It gets a dedicated one, placed before the
+        //  current slab so that one keeps being filled.
+        Uint8* t_pSlab = (Uint8*)SDL_malloc(t_uiBytes);
+        if (t_pSlab == NULL) return NULL;
+
+        m_vSlabs.insert(m_uiCurrentSize > 0 ? m_vSlabs.end() - 1 : m_vSlabs.end(), t_pSlab);
+        m_uiReserved += t_uiBytes;
+        m_uiUsed += t_uiBytes;
+        return t_pSlab;
+    }
+
+    if (!Reserve(t_uiBytes)) return NULL;
+
+    Uint8* t_pRet = m_vSlabs.back() + m_uiCurrentUsed;
+    m_uiCurrentUsed += t_uiBytes;
+    m_uiUsed += t_uiBytes;
+    return t_pRet;
+}
+
+void SampleArena::Release() {
+    for (auto t_pSlab : m_vSlabs)
+        SDL_free(t_pSlab);
+    m_vSlabs.clear();
+    m_uiCurrentSize = 0;
+    m_uiCurrentUsed = 0;
+    m_uiReserved = 0;
+    m_uiUsed = 0;
+}
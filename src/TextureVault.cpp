@@ -1,13 +1,15 @@
 #include "TextureVault.h"
+#include <algorithm>
 
 TextureVault::TextureVault(SDL_Renderer *p_Renderer, unsigned long p_ulExpirationTime, unsigned long p_ulAutoFreeTime)
-    :m_vTextures(), m_pRenderer(p_Renderer), m_ulExpirationTime(p_ulExpirationTime) {
+    :m_vTextures(), m_pRenderer(p_Renderer), m_ulExpirationTime(p_ulExpirationTime), m_Warmer(WarmLoad, WarmFree) {
 
     if (p_ulAutoFreeTime > 0) SetAutoFree(p_ulAutoFreeTime);
 }
 
 TextureVault::~TextureVault() {
     StopAutoFree();
+    m_Warmer.Stop();
     for (auto t_Entry : m_vTextures)
         SDL_DestroyTexture( *(t_Entry.m_pData) );
 }
@@ -15,9 +17,9 @@ TextureVault::~TextureVault() {
 std::shared_ptr<SDL_Texture*> TextureVault::GetTexture(std::string p_sPath) {
     if (!m_pRenderer) return std::shared_ptr<SDL_Texture*>();
 
-    for (auto t_Entry : m_vTextures)
+    for (auto& t_Entry : m_vTextures)
         if (t_Entry.m_sPath == p_sPath) {
-            t_Entry.m_ulExpiring = 0;
+            t_Entry.Touch();
             return std::shared_ptr<SDL_Texture*>(t_Entry.m_pData);
         }
 
@@ -37,6 +39,7 @@ std::shared_ptr<SDL_Texture*> TextureVault::GetTexture(std::string p_sPath) {
 std::shared_ptr<SDL_Texture*> TextureVault::PushNewTexture(SDL_Texture* p_pTexture, std::string p_sPath) {
     //Sets the path into our texture entry.
     TEntry t_TextureEntry(p_sPath);
+    t_TextureEntry.Touch();
     //Sets the strong reference (shared_ptr).
     t_TextureEntry.m_pData = std::make_shared<SDL_Texture*>(p_pTexture);
 
@@ -62,7 +65,7 @@ bool TextureVault::FreeUnused() {
         if ( t_Entry->m_pData.unique() ) {
             if (t_Entry->m_ulExpiring == 0)
                 t_Entry->m_ulExpiring = SDL_GetTicks();
-            if (SDL_GetTicks()-t_Entry->m_ulExpiring >= m_ulExpirationTime) {
+            if (t_Entry->IsExpired(m_ulExpirationTime, m_ulWarmUpGrace)) {
                 FreeTexture( &*t_Entry );
                 m_vTextures.erase(t_Entry);
                 t_bFreedSomething = true;
@@ -79,6 +82,59 @@ void TextureVault::Purge() {
     m_vTextures.clear();
 }
 
+bool TextureVault::SaveSnapshot(std::string p_sFile) {
+    std::vector<vault_snapshot_entry> t_vSnapshot;
+    CollectVaultSnapshot(t_vSnapshot, m_vTextures, 'T');
+    return WriteVaultSnapshot(p_sFile, t_vSnapshot);
+}
+
+bool TextureVault::LoadSnapshot(std::string p_sFile) {
+    std::vector<vault_snapshot_entry> t_vSnapshot;
+    if (!ReadVaultSnapshot(p_sFile, t_vSnapshot)) return false;
+
+    t_vSnapshot.erase(std::remove_if(t_vSnapshot.begin(), t_vSnapshot.end(),
+        [](const vault_snapshot_entry& t_Snap) { return t_Snap.m_cKind != 'T'; }), t_vSnapshot.end());
+    m_Warmer.Start(t_vSnapshot);
+
+    return true;
+}
+
+unsigned int TextureVault::WarmUp(unsigned long p_ulBudgetMS) {
+    if (!m_pRenderer) return m_Warmer.GetPending();
+
+    unsigned long t_ulStart = SDL_GetTicks();
+    vault_snapshot_entry t_Snap;
+    void* t_pData;
+
+    while (m_Warmer.Pop(t_Snap, t_pData)) {
+        SDL_Surface* t_pSurface = (SDL_Surface*)t_pData;
+
+        //Already requested by the game since the snapshot was loaded.
+        if (!CarryVaultSnapshot(m_vTextures, t_Snap)) {
+            //Only the upload happens here, the renderer can't be used from the worker.
+            SDL_Texture* t_pTexture = SDL_CreateTextureFromSurface(m_pRenderer, t_pSurface);
+            if (t_pTexture != NULL) {
+                PushNewTexture(t_pTexture, t_Snap.m_sPath);
+                //Carries a decayed access count over, but it wasn't used in this run yet.
+                m_vTextures.back().Warm(t_Snap.m_ulHits);
+            }
+        }
+        SDL_FreeSurface(t_pSurface);
+
+        if (SDL_GetTicks() - t_ulStart >= p_ulBudgetMS) break;
+    }
+
+    return m_Warmer.GetPending();
+}
+
+void* TextureVault::WarmLoad(const vault_snapshot_entry& p_Snap) {
+    return IMG_Load(p_Snap.m_sPath.c_str());
+}
+
+void TextureVault::WarmFree(const vault_snapshot_entry&, void* p_pData) {
+    SDL_FreeSurface((SDL_Surface*)p_pData);
+}
+
 SDL_Texture* TextureVault::LoadTexture (const char* p_pcPath) {
     //Load the texture
     SDL_Surface* t_pSurface = IMG_Load(p_pcPath);
@@ -0,0 +1,105 @@
+#include "VaultWarmer.h"
+
+VaultWarmer::VaultWarmer(LoadFunction p_pLoad, FreeFunction p_pFree):
+    m_vQueue(), m_dReady(), m_pLoad(p_pLoad), m_pFree(p_pFree) {
+    m_pMutex = SDL_CreateMutex();
+    m_pCond = SDL_CreateCond();
+}
+
+VaultWarmer::~VaultWarmer() {
+    Stop();
+    SDL_DestroyCond(m_pCond);
+    SDL_DestroyMutex(m_pMutex);
+}
+
+void VaultWarmer::Start(const std::vector<vault_snapshot_entry>& p_vSnapshot) {
+    Stop();
+    if (p_vSnapshot.empty()) return;
+
+    //The queue is consumed from the back, so the most important goes last.
+    m_vQueue.assign(p_vSnapshot.rbegin(), p_vSnapshot.rend());
+
+    if (m_pMutex != NULL && m_pCond != NULL)
+        m_pThread = SDL_CreateThread(VaultWarmer::Run, "VaultWarmer", this);
+}
+
+void VaultWarmer::Stop() {
+    if (m_pThread != NULL) {
+        SDL_LockMutex(m_pMutex);
+        m_bStop = true;
+        SDL_CondSignal(m_pCond);
+        SDL_UnlockMutex(m_pMutex);
+
+        SDL_WaitThread(m_pThread, NULL);
+        m_pThread = NULL;
+        m_bStop = false;
+    }
+
+    for (auto& t_Ready : m_dReady)
+        m_pFree(t_Ready.first, t_Ready.second);
+    m_dReady.clear();
+    m_vQueue.clear();
+}
+
+bool VaultWarmer::Pop(vault_snapshot_entry& p_Snap, void*& p_pData) {
+    if (m_pThread == NULL) {
+        //No worker, the assets are decoded here, one per call.
+        while (!m_vQueue.empty()) {
+            p_Snap = m_vQueue.back();
+            m_vQueue.pop_back();
+            p_pData = m_pLoad(p_Snap);
+            if (p_pData != NULL) return true;
+        }
+        return false;
+    }
+
+    SDL_LockMutex(m_pMutex);
+    bool t_bPopped = !m_dReady.empty();
+    if (t_bPopped) {
+        p_Snap = m_dReady.front().first;
+        p_pData = m_dReady.front().second;
+        m_dReady.pop_front();
+        //There is room again, the worker may continue.
+        SDL_CondSignal(m_pCond);
+    }
+    SDL_UnlockMutex(m_pMutex);
+
+    return t_bPopped;
+}
+
+unsigned int VaultWarmer::GetPending() {
+    if (m_pThread == NULL) return m_vQueue.size();
+
+    SDL_LockMutex(m_pMutex);
+    unsigned int t_uiPending = m_vQueue.size() + m_uiDecoding + m_dReady.size();
+    SDL_UnlockMutex(m_pMutex);
+
+    return t_uiPending;
+}
+
+int VaultWarmer::Run(void* p_Warmer) {
+    VaultWarmer* t_pWarmer = (VaultWarmer*)p_Warmer;
+
+    SDL_LockMutex(t_pWarmer->m_pMutex);
+    while (!t_pWarmer->m_bStop && !t_pWarmer->m_vQueue.empty()) {
+        //Decoding far ahead of WarmUp() would only hold memory.
+        if (t_pWarmer->m_dReady.size() >= WARMUP_READY_MAX) {
+            SDL_CondWait(t_pWarmer->m_pCond, t_pWarmer->m_pMutex);
+            continue;
+        }
+
+        vault_snapshot_entry t_Snap = t_pWarmer->m_vQueue.back();
+        t_pWarmer->m_vQueue.pop_back();
+        ++t_pWarmer->m_uiDecoding;
+        SDL_UnlockMutex(t_pWarmer->m_pMutex);
+
+        void* t_pData = t_pWarmer->m_pLoad(t_Snap);
+
+        SDL_LockMutex(t_pWarmer->m_pMutex);
+        --t_pWarmer->m_uiDecoding;
+        if (t_pData != NULL) t_pWarmer->m_dReady.push_back(std::make_pair(t_Snap, t_pData));
+    }
+    SDL_UnlockMutex(t_pWarmer->m_pMutex);
+
+    return 0;
+}